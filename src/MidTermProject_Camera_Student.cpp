@@ -35,6 +35,14 @@ int main(int argc, const char *argv[])
 
     bool bFocusOnVehicle = true;
     bool bLimitKpts = true;
+    int detectionScale = 1; // 1 (full resolution), 2 or 4: detect on an image downsampled by this factor, then refine keypoints at full resolution
+    bool bRefineSubPixel = true; // refine SHITOMASI and HARRIS keypoints detected at detectionScale > 1 on the full resolution image
+
+    checkDetectionScale(detectionScale);
+    if (descriptorType.compare("AKAZE") == 0 && detectionScale != 1)
+    { // AKAZE keypoints carry octave and class_id of the reduced image, which no longer match their full resolution pt and size
+        throw std::string("The AKAZE descriptor requires detectionScale = 1.");
+    }
 
     // camera
     string imgBasePath = dataPath + "images/";
@@ -71,6 +79,10 @@ int main(int argc, const char *argv[])
         // push image into data frame buffer
         DataFrame frame;
         frame.cameraImg = imgGray;
+        if (detectionScale > 1)
+        {
+            reduceImageResolution(imgGray, frame.cameraImgReduced, detectionScale);
+        }
         frame.imageIndex = imgIndex;
         dataBuffer.writeToBuffer(frame);
 
@@ -81,39 +93,43 @@ int main(int argc, const char *argv[])
 
         // extract 2D keypoints from current image
         vector<cv::KeyPoint> keypoints; // create empty feature list for current image
+        cv::Mat &imgDetect = detectionScale > 1 ? dataBuffer.getDataFrameAtLastIndexWritten()->cameraImgReduced : imgGray; // reuse the reduced image stored with the frame
 
         //// STUDENT ASSIGNMENT
         //// TASK MP.2 -> add the following keypoint detectors in file matching2D.cpp and enable string-based selection based on detectorType
         if (detectorType.compare("SHITOMASI") == 0)
         {
-            detKeypointsShiTomasi(keypoints, imgGray, false);
+            detKeypointsShiTomasi(keypoints, imgDetect, false);
         }
         else if (detectorType.compare("HARRIS") == 0)
         {
-            detKeypointsHarris(keypoints, imgGray, false);
+            detKeypointsHarris(keypoints, imgDetect, false);
         }
         else if (detectorType.compare("FAST") == 0)
         {
-            detKeypointsFAST(keypoints, imgGray, false);
+            detKeypointsFAST(keypoints, imgDetect, false);
         }
         else if (detectorType.compare("ORB") == 0)
         {
-            detKeypointsORB(keypoints, imgGray, false);
+            detKeypointsORB(keypoints, imgDetect, false);
         }
         else if (detectorType.compare("BRISK") == 0)
         {
-            detKeypointsBRISK(keypoints, imgGray, false);
+            detKeypointsBRISK(keypoints, imgDetect, false);
         }
         else if (detectorType.compare("AKAZE") == 0)
         {
-            detKeypointsAKAZE(keypoints, imgGray, false);
+            detKeypointsAKAZE(keypoints, imgDetect, false);
         }
         else if (detectorType.compare("SIFT") == 0)
         {
-            detKeypointsSIFT(keypoints, imgGray, false);
+            detKeypointsSIFT(keypoints, imgDetect, false);
         }
         //// EOF STUDENT ASSIGNMENT
 
+        // map keypoints from the reduced image back to full resolution coordinates
+        scaleKeypoints(keypoints, (float)detectionScale);
+
         //// STUDENT ASSIGNMENT
         //// TASK MP.3 -> only keep keypoints on the preceding vehicle
 
@@ -135,7 +151,7 @@ int main(int argc, const char *argv[])
         {
             int maxKeypoints = 20;
 
-            if (detectorType.compare("SHITOMASI") == 0)
+            if (detectorType.compare("SHITOMASI") == 0 && keypoints.size() > (size_t)maxKeypoints)
             { // there is no response info, so keep the first 50 as they are sorted in descending quality order
                 keypoints.erase(keypoints.begin() + maxKeypoints, keypoints.end());
             }
@@ -143,6 +159,12 @@ int main(int argc, const char *argv[])
             cout << " NOTE: Keypoints have been limited!" << endl;
         }
 
+        // only refine the corner keypoints that survived the filters, FAST, blob and scale-space keypoints keep their scaled positions
+        if (bRefineSubPixel && (detectorType.compare("SHITOMASI") == 0 || detectorType.compare("HARRIS") == 0))
+        {
+            refineKeypointsSubPixel(keypoints, imgGray, detectionScale);
+        }
+
         // push keypoints and descriptor for current frame to end of data buffer
         dataBuffer.getDataFrameAtLastIndexWritten() -> keypoints = keypoints;
         cout << "#2 : DETECT KEYPOINTS done" << endl;
@@ -152,7 +174,16 @@ int main(int argc, const char *argv[])
         //// STUDENT ASSIGNMENT
         //// TASK MP.4 -> add the following descriptors in file matching2D.cpp and enable string-based selection based on descriptorType
         cv::Mat descriptors;
-        descKeypoints(keypoints, imgGray, descriptors, descriptorType);
+        if (detectionScale > 1 && (descriptorType.compare("BRIEF") == 0 || descriptorType.compare("ORB") == 0 || descriptorType.compare("SIFT") == 0))
+        { // BRIEF samples a fixed patch, ORB picks its pyramid level from octave and SIFT unpacks octave and layer to pick its blur level,
+          // so describe on the reduced image, where octave still matches the keypoint geometry, to sample the same part of the scene the detector saw
+            descKeypointsReduced(keypoints, dataBuffer.getDataFrameAtLastIndexWritten()->cameraImgReduced, descriptors, descriptorType, detectionScale);
+            dataBuffer.getDataFrameAtLastIndexWritten()->keypoints = keypoints; // keep keypoints and descriptor rows aligned
+        }
+        else
+        {
+            descKeypoints(keypoints, imgGray, descriptors, descriptorType);
+        }
         //// EOF STUDENT ASSIGNMENT
 
         // push descriptors for current frame to end of data buffer
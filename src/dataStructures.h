@@ -9,6 +9,7 @@ struct DataFrame
 { // represents the available sensor information at the same time instance
     unsigned int imageIndex; // in a real camera streaming scenario, we should handle overflow at MAX_INT
     cv::Mat cameraImg; // camera image    
+    cv::Mat cameraImgReduced; // camera image downsampled for keypoint detection (empty when detecting at full resolution)
     std::vector<cv::KeyPoint> keypoints; // 2D keypoints within camera image
     cv::Mat descriptors; // keypoint descriptors
     std::vector<cv::DMatch> kptMatches; // keypoint matches between previous and current frame
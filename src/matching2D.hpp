@@ -27,6 +27,11 @@ void detKeypointsORB(std::vector<cv::KeyPoint> &keypoints, cv::Mat &img, bool bV
 void detKeypointsAKAZE(std::vector<cv::KeyPoint> &keypoints, cv::Mat &img, bool bVis=false);
 void detKeypointsSIFT(std::vector<cv::KeyPoint> &keypoints, cv::Mat &img, bool bVis=false);
 void visualizeKeyPoints(std::vector<cv::KeyPoint> &keypoints, cv::Mat &img, bool bVis, std::string detectorName);
+void checkDetectionScale(int detectionScale);
+void reduceImageResolution(cv::Mat &img, cv::Mat &imgReduced, int detectionScale);
+void scaleKeypoints(std::vector<cv::KeyPoint> &keypoints, float scaleFactor);
+void descKeypointsReduced(std::vector<cv::KeyPoint> &keypoints, cv::Mat &imgReduced, cv::Mat &descriptors, std::string descriptorType, int detectionScale);
+void refineKeypointsSubPixel(std::vector<cv::KeyPoint> &keypoints, cv::Mat &img, int detectionScale);
 void detKeypointsModern(std::vector<cv::KeyPoint> &keypoints, cv::Mat &img, std::string detectorType, bool bVis=false);
 void descKeypoints(std::vector<cv::KeyPoint> &keypoints, cv::Mat &img, cv::Mat &descriptors, std::string descriptorType);
 void matchDescriptors(std::vector<cv::KeyPoint> &kPtsSource, std::vector<cv::KeyPoint> &kPtsRef, cv::Mat &descSource, cv::Mat &descRef,
@@ -242,4 +242,120 @@ void visualizeKeyPoints(vector<KeyPoint> &keypoints, Mat &img, bool bVis, std::s
         imshow(windowName, visImage);
         waitKey(0);
     }
-}
\ No newline at end of file
+}
+
+//***** Reduced-resolution detection *****//
+
+// Only power of two reductions map pixel (x, y) of the reduced image exactly to (detectionScale * x, detectionScale * y)
+void checkDetectionScale(int detectionScale)
+{
+    if (detectionScale != 1 && detectionScale != 2 && detectionScale != 4)
+    {
+        throw std::string("detectionScale must be 1, 2 or 4.");
+    }
+}
+
+// Downsample image by detectionScale (1, 2 or 4) using a Gaussian pyramid so detectors only have to process 1/detectionScale^2 of the pixels
+void reduceImageResolution(Mat &img, Mat &imgReduced, int detectionScale)
+{
+    checkDetectionScale(detectionScale);
+
+    double t = (double)getTickCount();
+    imgReduced = img;
+    for (int scale = detectionScale; scale > 1; scale /= 2)
+    {
+        pyrDown(imgReduced, imgReduced); // blur then drop every other row and column, pixel (x, y) maps to (2x, 2y) in the level above
+    }
+    t = ((double)getTickCount() - t) / getTickFrequency();
+    std::cout << "Image reduced by " << detectionScale << "x to " << imgReduced.cols << "x" << imgReduced.rows << " in " << 1000 * t / 1.0 << " ms" << endl;
+}
+
+// Map keypoints between the reduced and the full resolution image, scaleFactor = detectionScale maps to full resolution, 1 / detectionScale back
+void scaleKeypoints(vector<KeyPoint> &keypoints, float scaleFactor)
+{
+    if (scaleFactor == 1.0f)
+    {
+        return;
+    }
+    for (auto it = keypoints.begin(); it != keypoints.end(); ++it)
+    {
+        (*it).pt *= scaleFactor;
+        (*it).size *= scaleFactor; // keep the keypoint neighbourhood the same part of the scene
+    }
+}
+
+// Compute descriptors for full resolution keypoints on the reduced image, for descriptors that do not scale their patch with KeyPoint::size
+// the reduced image is padded first, otherwise BRIEF (28 px) and ORB (edgeThreshold = 31 px) drop every keypoint within their border of the
+// reduced image edge, which at 4x removes about half of the vehicle ROI area
+void descKeypointsReduced(vector<KeyPoint> &keypoints, Mat &imgReduced, Mat &descriptors, string descriptorType, int detectionScale)
+{
+    int borderSize = 32; // covers the BRIEF patch radius and the ORB edgeThreshold at pyramid level 0
+    Mat imgPadded;
+    copyMakeBorder(imgReduced, imgPadded, borderSize, borderSize, borderSize, borderSize, BORDER_REFLECT_101);
+
+    vector<KeyPoint> keypointsReduced = keypoints;
+    scaleKeypoints(keypointsReduced, 1.0f / detectionScale);
+    for (auto it = keypointsReduced.begin(); it != keypointsReduced.end(); ++it)
+    {
+        (*it).pt += Point2f((float)borderSize, (float)borderSize);
+    }
+
+    descKeypoints(keypointsReduced, imgPadded, descriptors, descriptorType);
+
+    // the extractor may still drop keypoints, return the survivors so keypoints and descriptor rows stay aligned
+    for (auto it = keypointsReduced.begin(); it != keypointsReduced.end(); ++it)
+    {
+        (*it).pt -= Point2f((float)borderSize, (float)borderSize);
+    }
+    scaleKeypoints(keypointsReduced, (float)detectionScale);
+    std::cout << descriptorType << " on reduced image dropped " << keypoints.size() - keypointsReduced.size() << " of " << keypoints.size() << " keypoints" << endl;
+    keypoints = keypointsReduced;
+}
+
+// Refine corner keypoint locations on the full resolution image, recovering the precision lost by detecting on the reduced image
+// only meant for the corner detectors SHITOMASI and HARRIS, blob centres and FAST segment points get pulled towards nearby gradients
+// references https://docs.opencv.org/3.4/dd/d1a/group__imgproc__feature.html#ga354e0d7c86d0d9da75de9b9701a9a87e
+void refineKeypointsSubPixel(vector<KeyPoint> &keypoints, Mat &img, int detectionScale)
+{
+    if (detectionScale == 1 || keypoints.empty())
+    {
+        return;
+    }
+
+    Size winSize(2 * detectionScale, 2 * detectionScale); // half of the search window, 2 reduced pixels so it stays on the detected corner
+    Size zeroZone(-1, -1); // no dead region in the middle of the search window
+    TermCriteria criteria(TermCriteria::EPS + TermCriteria::COUNT, 20, 0.03); // stop after 20 iterations or when the corner moves less than 0.03 px
+
+    double t = (double)getTickCount();
+    vector<Point2f> corners;
+    KeyPoint::convert(keypoints, corners);
+    cornerSubPix(img, corners, winSize, zeroZone, criteria);
+
+    // cornerSubPix returns the start point when it leaves the search window, so a zero shift means it did not converge.
+    // Larger shifts than the detector quantization error of 1.5 reduced pixels jumped to neighbouring structure.
+    // Both keep the scaled position and are left out of the shift statistics.
+    float maxShift = 1.5f * detectionScale;
+    int nAccepted = 0, nRejected = 0;
+    double sumShift = 0.0, maxAcceptedShift = 0.0;
+    for (size_t i = 0; i < keypoints.size(); ++i)
+    {
+        Point2f shift = corners[i] - keypoints[i].pt;
+        bool bConverged = shift.x != 0.0f || shift.y != 0.0f;
+        if (bConverged && std::abs(shift.x) <= maxShift && std::abs(shift.y) <= maxShift)
+        {
+            double shiftNorm = norm(shift);
+            sumShift += shiftNorm;
+            maxAcceptedShift = max(maxAcceptedShift, shiftNorm);
+            keypoints[i].pt = corners[i];
+            nAccepted++;
+        }
+        else
+        {
+            nRejected++;
+        }
+    }
+    t = ((double)getTickCount() - t) / getTickFrequency();
+    std::cout << "Sub-pixel refinement of n=" << keypoints.size() << " keypoints in " << 1000 * t / 1.0 << " ms"
+              << ", accepted=" << nAccepted << " rejected=" << nRejected
+              << ", shift mean=" << (nAccepted > 0 ? sumShift / nAccepted : 0.0) << " px max=" << maxAcceptedShift << " px" << endl;
+}
@@ -0,0 +1,112 @@
+// test for reduced-resolution detection with sub-pixel refinement
+#include <assert.h>
+#include <iostream>
+#include "../src/matching2D.hpp"
+
+// synthetic image with two bright quadrants touching in an X-corner between pixels (199, 149) and (200, 150)
+cv::Mat createSyntheticCorner() {
+    cv::Mat img = cv::Mat::zeros(300, 400, CV_8UC1);
+    img(cv::Rect(0, 0, 200, 150)).setTo(255);
+    img(cv::Rect(200, 150, 200, 150)).setTo(255);
+    cv::GaussianBlur(img, img, cv::Size(5, 5), 1.0); // soften the step edge like a camera lens would
+    return img;
+}
+
+// return the keypoint closest to point
+cv::KeyPoint findClosestKeypoint(std::vector<cv::KeyPoint> &keypoints, cv::Point2f point) {
+    assert(!keypoints.empty());
+    cv::KeyPoint closest = keypoints[0];
+    for (auto it = keypoints.begin(); it != keypoints.end(); ++it) {
+        if (cv::norm((*it).pt - point) < cv::norm(closest.pt - point)) closest = *it;
+    }
+    return closest;
+}
+
+// Should multiply keypoint position and size by the scale factor, and map them back with the inverse scale factor.
+void test_scaleKeypoints() {
+    std::vector<cv::KeyPoint> keypoints;
+    keypoints.push_back(cv::KeyPoint(cv::Point2f(10.25f, 20.5f), 4.0f));
+    scaleKeypoints(keypoints, 4.0f);
+    assert(keypoints[0].pt == cv::Point2f(41.0f, 82.0f));
+    assert(keypoints[0].size == 16.0f);
+    scaleKeypoints(keypoints, 1.0f / 4);
+    assert(keypoints[0].pt == cv::Point2f(10.25f, 20.5f));
+    assert(keypoints[0].size == 4.0f);
+    std::cout << "test_scaleKeypoints test passed" << std::endl;
+}
+
+// Should reduce the image by detectionScale, detect the corner with Shi-Tomasi, scale it to full resolution and refine it to within 0.1 px of the true corner.
+void test_refineCornerAtScale(int detectionScale) {
+    const cv::Point2f trueCorner(199.5f, 149.5f);
+    const double tolerance = 0.1; // px at full resolution
+    cv::Mat img = createSyntheticCorner();
+
+    cv::Mat imgReduced;
+    reduceImageResolution(img, imgReduced, detectionScale);
+    assert(imgReduced.cols == img.cols / detectionScale && imgReduced.rows == img.rows / detectionScale);
+
+    std::vector<cv::KeyPoint> keypoints;
+    detKeypointsShiTomasi(keypoints, imgReduced, false);
+    scaleKeypoints(keypoints, (float)detectionScale);
+    cv::KeyPoint scaled = findClosestKeypoint(keypoints, trueCorner);
+
+    std::vector<cv::KeyPoint> refined(1, scaled);
+    refineKeypointsSubPixel(refined, img, detectionScale);
+    double scaledError = cv::norm(scaled.pt - trueCorner);
+    double refinedError = cv::norm(refined[0].pt - trueCorner);
+    std::cout << "detectionScale=" << detectionScale << " scaled error=" << scaledError << " px, refined error=" << refinedError << " px" << std::endl;
+    assert(refinedError < tolerance);
+    assert(refinedError < scaledError);
+    std::cout << "test_refineCornerAtScale(" << detectionScale << ") test passed" << std::endl;
+}
+
+// Should keep the scaled position of a keypoint in a flat region, where cornerSubPix does not converge, and of a keypoint whose refinement moves further than 1.5 reduced pixels.
+void test_rejectRefinement() {
+    const int detectionScale = 2;
+    cv::Mat img = createSyntheticCorner();
+    std::vector<cv::KeyPoint> keypoints;
+    keypoints.push_back(cv::KeyPoint(cv::Point2f(100.0f, 250.0f), 8.0f)); // flat region, far from any gradient
+    keypoints.push_back(cv::KeyPoint(cv::Point2f(203.5f, 149.5f), 8.0f)); // 2 reduced pixels right of the corner, beyond the gate
+    std::vector<cv::KeyPoint> refined = keypoints;
+    refineKeypointsSubPixel(refined, img, detectionScale);
+    assert(refined[0].pt == keypoints[0].pt);
+    assert(refined[1].pt == keypoints[1].pt);
+    std::cout << "test_rejectRefinement test passed" << std::endl;
+}
+
+// Should throw error "detectionScale must be 1, 2 or 4."
+void test_reduceWithInvalidScale() {
+    cv::Mat img = createSyntheticCorner();
+    cv::Mat imgReduced;
+    bool thrown = false;
+    try {
+        reduceImageResolution(img, imgReduced, 3);
+    } catch (std::string err) {
+        const std::string expectedError = "detectionScale must be 1, 2 or 4.";
+        std::cout << "actual error is " << err << std::endl;
+        assert(expectedError.compare(err) == 0);
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "test_reduceWithInvalidScale test passed" << std::endl;
+}
+
+int main ()
+{
+    std::cout << "Starting test test_scaleKeypoints." << std::endl;
+    test_scaleKeypoints();
+    std::cout << "Finished test test_scaleKeypoints." << std::endl;
+
+    std::cout << "Starting test test_refineCornerAtScale." << std::endl;
+    test_refineCornerAtScale(2);
+    test_refineCornerAtScale(4);
+    std::cout << "Finished test test_refineCornerAtScale." << std::endl;
+
+    std::cout << "Starting test test_rejectRefinement." << std::endl;
+    test_rejectRefinement();
+    std::cout << "Finished test test_rejectRefinement." << std::endl;
+
+    std::cout << "Starting test test_reduceWithInvalidScale." << std::endl;
+    test_reduceWithInvalidScale();
+    std::cout << "Finished test test_reduceWithInvalidScale." << std::endl;
+}